@@ -8,8 +8,11 @@
 #include <boost/multi_array.hpp>
 #include <boost/python.hpp>
 #include <boost/python/numpy.hpp>
+#include <cstring>
 #include <memory>
 #include <stdint.h>
+#include <thread>
+#include <type_traits>
 #include <vector>
 
 //  Using from python is avoided because many definitions conflict with names from std.
@@ -116,6 +119,15 @@ namespace python_multi_array
             }
         }
 
+        //  unlike make_typed_sized, the array is not reset with zero
+        //  because the caller overwrites every element.
+        template <class T, size_t N>
+        shared_ptr<multi_array<T, N>> allocate_typed_sized(const size_t* s)
+        {
+            vector<size_t> shape_vector(s, s + N);
+            return std::make_shared<multi_array<T, N>>(shape_vector);
+        }
+
         template <class T>
         python::object make_typed(python::object shape)
         {
@@ -345,7 +357,8 @@ namespace python_multi_array
     //  [Python]
     //  numpy.ndarray x.get()
     //
-    //  return: a copy of the array stored in numpy.ndarray.
+    //  return: numpy.ndarray sharing the memory of the array.
+    //          the ndarray keeps the array alive while it is referenced.
     //
     template <class T, size_t N>
     python::object get(const shared_ptr<multi_array<T, N>>& This)
@@ -383,7 +396,7 @@ namespace python_multi_array
         python::numpy::dtype dt = python::numpy::dtype::get_builtin<T>();
         python::tuple shape = make_tuple_from_array(s);
         python::tuple strides = make_tuple_from_array(d);
-        return boost::python::numpy::from_data(This->origin(), dt, shape, strides, boost::python::object());
+        return boost::python::numpy::from_data(This->origin(), dt, shape, strides, python::object(This));
     }
 
     //
@@ -506,6 +519,434 @@ namespace python_multi_array
         }
     }
 
+    //
+    //  [Python]
+    //  multi_array.set_parallel(grain, max_threads)
+    //
+    //  configure how copy_from, clone and astype split large arrays into threads.
+    //
+    //  grain: the minimum number of elements converted by one thread
+    //  max_threads: the maximum number of threads, or 0 to use the number of
+    //               hardware threads
+    //
+    //  return: a tuple of the previous grain and max_threads.
+    //
+    python::tuple set_parallel(size_t grain, size_t max_threads);
+
+    namespace impl
+    {
+        size_t parallel_grain = 1 << 20;
+        size_t parallel_max_threads = 0;
+    }
+
+    python::tuple set_parallel(size_t grain, size_t max_threads)
+    {
+        if (grain == 0)
+        {
+            throw std::invalid_argument("grain");
+        }
+        python::tuple previous = python::make_tuple(impl::parallel_grain, impl::parallel_max_threads);
+        impl::parallel_grain = grain;
+        impl::parallel_max_threads = max_threads;
+        return previous;
+    }
+
+    //
+    //  [Python]
+    //  x.copy_from(array_type other)
+    //
+    //  Reset the array with values from other, without going through numpy.
+    //  other must have the same shape as x.
+    //  other.element() may be different from x.element() but the values are
+    //  implicitly converted to x.element().
+    //
+    template <class T, size_t N>
+    void copy_from(const shared_ptr<multi_array<T, N>>& This, python::object other);
+
+    namespace impl
+    {
+        //  release the GIL while only raw buffers are touched.
+        class scoped_gil_release
+        {
+        public:
+            scoped_gil_release() : m_state(PyEval_SaveThread()) {}
+            ~scoped_gil_release() { PyEval_RestoreThread(m_state); }
+            scoped_gil_release(const scoped_gil_release&) = delete;
+            scoped_gil_release& operator=(const scoped_gil_release&) = delete;
+
+        private:
+            PyThreadState* m_state;
+        };
+
+        template <class T, class S>
+        void convert_contiguous(T* dst, const S* src, size_t size)
+        {
+            if (std::is_same<T, S>::value)
+            {
+                std::memcpy(dst, src, size * sizeof(T));
+            }
+            else
+            {
+                std::transform(src, src + size, dst, [](S input) { return static_cast<T>(input); });
+            }
+        }
+
+        template <class T, class S>
+        void convert_parallel(T* dst, const S* src, size_t size)
+        {
+            //  read the settings while the GIL is still held.
+            size_t max_threads = (parallel_max_threads == 0) ? std::thread::hardware_concurrency() : parallel_max_threads;
+            size_t num_threads = std::min(max_threads, size / parallel_grain);
+
+            scoped_gil_release release;
+            if (num_threads <= 1)
+            {
+                convert_contiguous(dst, src, size);
+                return;
+            }
+            size_t chunk = (size + num_threads - 1) / num_threads;
+            vector<std::thread> threads;
+            try
+            {
+                for (size_t begin = chunk; begin < size; begin += chunk)
+                {
+                    threads.emplace_back(convert_contiguous<T, S>, dst + begin, src + begin, std::min(chunk, size - begin));
+                }
+            }
+            catch (...)
+            {
+                for (auto& t : threads)
+                {
+                    t.join();
+                }
+                throw;
+            }
+            convert_contiguous(dst, src, chunk);
+            for (auto& t : threads)
+            {
+                t.join();
+            }
+        }
+
+        template <class T, class S>
+        void copy_buffer(T* dst, const size_t* dst_shape, const ptrdiff_t* dst_strides, const S* src, const size_t* src_shape,
+                         const ptrdiff_t* src_strides, size_t ndim, size_t num_elements)
+        {
+            if (std::equal(dst_shape, dst_shape + ndim, src_shape) == false)
+            {
+                throw std::invalid_argument("other");
+            }
+            if (std::equal(dst_strides, dst_strides + ndim, src_strides) == false)
+            {
+                //  arrays allocated by this module are always in c-order,
+                //  but arrays from C++ may have other storage orders.
+                throw std::invalid_argument("other");
+            }
+            if (static_cast<const void*>(dst) != static_cast<const void*>(src))
+            {
+                convert_parallel(dst, src, num_elements);
+            }
+        }
+
+        enum class element_type
+        {
+            bool8, uint8, uint16, uint32, uint64, int8, int16, int32, int64, float32, float64
+        };
+
+        template <class T>
+        struct element_traits;
+
+        template <>
+        struct element_traits<bool>
+        {
+            static const element_type type = element_type::bool8;
+        };
+
+        template <>
+        struct element_traits<uint8_t>
+        {
+            static const element_type type = element_type::uint8;
+        };
+
+        template <>
+        struct element_traits<uint16_t>
+        {
+            static const element_type type = element_type::uint16;
+        };
+
+        template <>
+        struct element_traits<uint32_t>
+        {
+            static const element_type type = element_type::uint32;
+        };
+
+        template <>
+        struct element_traits<uint64_t>
+        {
+            static const element_type type = element_type::uint64;
+        };
+
+        template <>
+        struct element_traits<int8_t>
+        {
+            static const element_type type = element_type::int8;
+        };
+
+        template <>
+        struct element_traits<int16_t>
+        {
+            static const element_type type = element_type::int16;
+        };
+
+        template <>
+        struct element_traits<int32_t>
+        {
+            static const element_type type = element_type::int32;
+        };
+
+        template <>
+        struct element_traits<int64_t>
+        {
+            static const element_type type = element_type::int64;
+        };
+
+        template <>
+        struct element_traits<float>
+        {
+            static const element_type type = element_type::float32;
+        };
+
+        template <>
+        struct element_traits<double>
+        {
+            static const element_type type = element_type::float64;
+        };
+
+        //  a source array whose element type is known only at runtime.
+        struct array_buffer
+        {
+            element_type type;
+            const void* data;
+            const size_t* shape;
+            const ptrdiff_t* strides;
+            shared_ptr<const void> owner;
+        };
+
+        template <class S, size_t N>
+        array_buffer make_buffer(const shared_ptr<multi_array<S, N>>& src)
+        {
+            array_buffer buffer;
+            buffer.type = element_traits<S>::type;
+            buffer.data = src->data();
+            buffer.shape = src->shape();
+            buffer.strides = src->strides();
+            buffer.owner = src;
+            return buffer;
+        }
+
+        template <class S, size_t N>
+        bool extract_buffer_typed(python::object other, array_buffer& buffer)
+        {
+            python::extract<shared_ptr<multi_array<S, N>>> extractor(other);
+            if (extractor.check() == false)
+            {
+                return false;
+            }
+            shared_ptr<multi_array<S, N>> src = extractor();
+            if (src == nullptr)
+            {
+                return false;
+            }
+            buffer = make_buffer(src);
+            return true;
+        }
+
+        template <size_t N>
+        array_buffer extract_buffer(python::object other)
+        {
+            array_buffer buffer;
+            bool extracted = extract_buffer_typed<bool, N>(other, buffer) || extract_buffer_typed<uint8_t, N>(other, buffer) ||
+                             extract_buffer_typed<uint16_t, N>(other, buffer) || extract_buffer_typed<uint32_t, N>(other, buffer) ||
+                             extract_buffer_typed<uint64_t, N>(other, buffer) || extract_buffer_typed<int8_t, N>(other, buffer) ||
+                             extract_buffer_typed<int16_t, N>(other, buffer) || extract_buffer_typed<int32_t, N>(other, buffer) ||
+                             extract_buffer_typed<int64_t, N>(other, buffer) || extract_buffer_typed<float, N>(other, buffer) ||
+                             extract_buffer_typed<double, N>(other, buffer);
+            if (extracted == false)
+            {
+                //  other is not an array, or has a different dimensionality
+                throw std::invalid_argument("other");
+            }
+            return buffer;
+        }
+
+        template <class T>
+        void copy_from_buffer(T* dst, const size_t* dst_shape, const ptrdiff_t* dst_strides, size_t ndim, size_t num_elements, const array_buffer& src)
+        {
+            switch (src.type)
+            {
+                case element_type::bool8:
+                    copy_buffer(dst, dst_shape, dst_strides, static_cast<const bool*>(src.data), src.shape, src.strides, ndim, num_elements);
+                    break;
+                case element_type::uint8:
+                    copy_buffer(dst, dst_shape, dst_strides, static_cast<const uint8_t*>(src.data), src.shape, src.strides, ndim, num_elements);
+                    break;
+                case element_type::uint16:
+                    copy_buffer(dst, dst_shape, dst_strides, static_cast<const uint16_t*>(src.data), src.shape, src.strides, ndim, num_elements);
+                    break;
+                case element_type::uint32:
+                    copy_buffer(dst, dst_shape, dst_strides, static_cast<const uint32_t*>(src.data), src.shape, src.strides, ndim, num_elements);
+                    break;
+                case element_type::uint64:
+                    copy_buffer(dst, dst_shape, dst_strides, static_cast<const uint64_t*>(src.data), src.shape, src.strides, ndim, num_elements);
+                    break;
+                case element_type::int8:
+                    copy_buffer(dst, dst_shape, dst_strides, static_cast<const int8_t*>(src.data), src.shape, src.strides, ndim, num_elements);
+                    break;
+                case element_type::int16:
+                    copy_buffer(dst, dst_shape, dst_strides, static_cast<const int16_t*>(src.data), src.shape, src.strides, ndim, num_elements);
+                    break;
+                case element_type::int32:
+                    copy_buffer(dst, dst_shape, dst_strides, static_cast<const int32_t*>(src.data), src.shape, src.strides, ndim, num_elements);
+                    break;
+                case element_type::int64:
+                    copy_buffer(dst, dst_shape, dst_strides, static_cast<const int64_t*>(src.data), src.shape, src.strides, ndim, num_elements);
+                    break;
+                case element_type::float32:
+                    copy_buffer(dst, dst_shape, dst_strides, static_cast<const float*>(src.data), src.shape, src.strides, ndim, num_elements);
+                    break;
+                case element_type::float64:
+                    copy_buffer(dst, dst_shape, dst_strides, static_cast<const double*>(src.data), src.shape, src.strides, ndim, num_elements);
+                    break;
+                default:
+                    throw std::invalid_argument("other");
+            }
+        }
+    }
+
+    template <class T, size_t N>
+    void copy_from(const shared_ptr<multi_array<T, N>>& This, python::object other)
+    {
+        if (This == nullptr)
+        {
+            throw std::invalid_argument("self");
+        }
+        //  the source is resolved separately from T and N,
+        //  so that the dispatch is not compiled for every pair of array types.
+        impl::array_buffer src = impl::extract_buffer<N>(other);
+        impl::copy_from_buffer(This->data(), This->shape(), This->strides(), N, This->num_elements(), src);
+    }
+
+    //
+    //  [Python]
+    //  [array_type] x.astype(dtype)
+    //
+    //  allocate a new array of the same shape as x and the given data type,
+    //  and fill it with the values of x converted to dtype.
+    //
+    //  dtype: bool8, int8, int16, int32, int64, uint8, uint16, uint32, uint64,
+    //         float32 or float64, all defined in numpy
+    //
+    //  return: a smart-pointer of the new array
+    //
+    template <class T, size_t N>
+    python::object astype(const shared_ptr<multi_array<T, N>>& This, python::object dtype);
+
+    namespace impl
+    {
+        template <class U, size_t N>
+        python::object astype_typed(const array_buffer& src)
+        {
+            shared_ptr<multi_array<U, N>> dst;
+            {
+                //  multi_array initializes every element on construction,
+                //  which is slow for large arrays but does not need the GIL.
+                scoped_gil_release release;
+                dst = allocate_typed_sized<U, N>(src.shape);
+            }
+            copy_from_buffer(dst->data(), dst->shape(), dst->strides(), N, dst->num_elements(), src);
+            return python::object(dst);
+        }
+
+        template <size_t N>
+        python::object astype_buffer(const array_buffer& src, python::object dtype)
+        {
+            if (dtype == bool8)
+            {
+                return astype_typed<bool, N>(src);
+            }
+            else if (dtype == uint8)
+            {
+                return astype_typed<uint8_t, N>(src);
+            }
+            else if (dtype == uint16)
+            {
+                return astype_typed<uint16_t, N>(src);
+            }
+            else if (dtype == uint32)
+            {
+                return astype_typed<uint32_t, N>(src);
+            }
+            else if (dtype == uint64)
+            {
+                return astype_typed<uint64_t, N>(src);
+            }
+            else if (dtype == int8)
+            {
+                return astype_typed<int8_t, N>(src);
+            }
+            else if (dtype == int16)
+            {
+                return astype_typed<int16_t, N>(src);
+            }
+            else if (dtype == int32)
+            {
+                return astype_typed<int32_t, N>(src);
+            }
+            else if (dtype == int64)
+            {
+                return astype_typed<int64_t, N>(src);
+            }
+            else if (dtype == float32)
+            {
+                return astype_typed<float, N>(src);
+            }
+            else if (dtype == float64)
+            {
+                return astype_typed<double, N>(src);
+            }
+            else
+            {
+                throw std::invalid_argument("dtype");
+            }
+        }
+    }
+
+    template <class T, size_t N>
+    python::object astype(const shared_ptr<multi_array<T, N>>& This, python::object dtype)
+    {
+        if (This == nullptr)
+        {
+            throw std::invalid_argument("self");
+        }
+        return impl::astype_buffer<N>(impl::make_buffer(This), dtype);
+    }
+
+    //
+    //  [Python]
+    //  [array_type] x.clone()
+    //
+    //  return: a new array with the same shape, data type and values as x.
+    //
+    template <class T, size_t N>
+    python::object clone(const shared_ptr<multi_array<T, N>>& This)
+    {
+        if (This == nullptr)
+        {
+            throw std::invalid_argument("self");
+        }
+        return impl::astype_typed<T, N>(impl::make_buffer(This));
+    }
+
     //
     //  [Internal-usage only]
     //  let python interpreter to export types from this module.
@@ -525,7 +966,10 @@ namespace python_multi_array
                 .def("num_dimensions", &num_dimensions<T, N>)
                 .def("num_elements", &num_elements<T, N>)
                 .def("get", &get<T, N>)
-                .def("set", &set<T, N>);
+                .def("set", &set<T, N>)
+                .def("copy_from", &copy_from<T, N>)
+                .def("clone", &clone<T, N>)
+                .def("astype", &astype<T, N>);
         }
     };
 }
@@ -626,6 +1070,7 @@ BOOST_PYTHON_MODULE(multi_array)
     array_template::declare<double, 8>("shared_double_tensor8");
 
     def("make", make);
+    def("set_parallel", set_parallel);
 
     //  define aliases of numpy data types
     python::scope This;
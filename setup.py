@@ -29,7 +29,8 @@ for module in modules:
         include_dirs = [numpy.get_include()] + include_dirs,
         libraries = ['boost_python', 'boost_numpy'],
         library_dirs = library_dirs,
-        extra_compile_args=['-std=c++14'],
+        extra_compile_args=['-std=c++14', '-pthread'],
+        extra_link_args=['-pthread'],
     )
     extensions.append(ex_module)
 
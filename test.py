@@ -56,5 +56,81 @@ class TestMultiArray(unittest.TestCase):
             ix = np.int32(shape * np.random.rand(ndim))
             self.assertEqual(x[ix], dtype(y[tuple(ix)]))
 
+    def test_copy_all(self):
+        dtypes = [
+            np.bool8,
+            np.uint8,
+            np.uint16,
+            np.uint32,
+            np.uint64,
+            np.int8,
+            np.int16,
+            np.int32,
+            np.int64,
+            np.float32,
+            np.float64
+        ]
+        for iiter in range(100):
+            ndim = np.int32(np.random.rand() * 8 + 1)       # 1 to 8
+            shape = np.int32(np.random.rand(ndim) * 4 + 1)  # 1 to 4
+            src_type = dtypes[int(np.random.rand() * len(dtypes))]
+            dst_type = dtypes[int(np.random.rand() * len(dtypes))]
+            nelem = np.array(shape).prod()
+
+            # converting negative floats into unsigned types is undefined,
+            # both in x.set() and in the conversion from x
+            unsigned = [np.uint8, np.uint16, np.uint32, np.uint64]
+            floats = [np.float32, np.float64]
+            negative_float_to_unsigned = (src_type in unsigned) or (src_type in floats and dst_type in unsigned)
+            offset = 0 if negative_float_to_unsigned else 5
+
+            x = ma.make(shape, src_type)
+            x.set((np.random.rand(nelem) * 10 - offset).reshape(shape))
+
+            y = x.clone()
+            self.assertEqual(y.element(), src_type)
+            self.assertEqual(y.shape(), tuple(shape))
+            self.assertTrue((y.get() == x.get()).all())
+
+            z = x.astype(dst_type)
+            self.assertEqual(z.element(), dst_type)
+            self.assertEqual(z.shape(), tuple(shape))
+            self.assertTrue((z.get() == x.get().astype(dst_type)).all())
+
+            w = ma.make(shape, dst_type)
+            w.copy_from(x)
+            self.assertTrue((w.get() == z.get()).all())
+
+    def test_copy_large(self):
+        # split 10007 elements into 4 threads of uneven chunks
+        previous = ma.set_parallel(1000, 4)
+        try:
+            n = 10007
+            y = np.arange(n) * 0.5 - 2500
+            x = ma.make(n, np.float64)
+            x.set(y)
+            z = ma.make(n, np.int32)
+            z.copy_from(x)
+            self.assertTrue((z.get() == np.int32(y)).all())
+            self.assertTrue((x.clone().get() == y).all())
+            self.assertTrue((x.astype(np.int16).get() == np.int16(y)).all())
+        finally:
+            self.assertEqual(ma.set_parallel(*previous), (1000, 4))
+
+    def test_get_temporary(self):
+        x = ma.make(4, np.float64)
+        x.set(np.array([-1, 0, 1, 3]))
+        y = x.astype(np.int32).get()
+        ma.make(4, np.int32).reset()
+        self.assertTrue((y == np.array([-1, 0, 1, 3])).all())
+
+    def test_copy_invalid(self):
+        x = ma.make((2, 4), np.float32)
+        self.assertRaises(ValueError, x.copy_from, ma.make((4, 2), np.float32))
+        self.assertRaises(ValueError, x.copy_from, ma.make(8, np.float32))
+        self.assertRaises(ValueError, x.copy_from, np.zeros((2, 4)))
+        self.assertRaises(ValueError, x.astype, np.complex64)
+        self.assertRaises(ValueError, ma.set_parallel, 0, 4)
+
 if (__name__ == '__main__'):
     unittest.main()